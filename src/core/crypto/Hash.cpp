@@ -0,0 +1,161 @@
+// src/core/crypto/Hash.cpp
+#include "Hash.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr uint32_t K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+// Incremental SHA-256 state; only used inside this file.
+struct Sha256Ctx {
+  uint32_t h[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+  uint8_t  buf[64] = {};
+  size_t   bufLen = 0;
+  uint64_t total = 0;
+
+  void block(const uint8_t* p) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+      w[i] = (uint32_t(p[4*i]) << 24) | (uint32_t(p[4*i+1]) << 16) |
+             (uint32_t(p[4*i+2]) << 8) | uint32_t(p[4*i+3]);
+    }
+    for (int i = 16; i < 64; ++i) {
+      uint32_t s0 = rotr(w[i-15], 7) ^ rotr(w[i-15], 18) ^ (w[i-15] >> 3);
+      uint32_t s1 = rotr(w[i-2], 17) ^ rotr(w[i-2], 19) ^ (w[i-2] >> 10);
+      w[i] = w[i-16] + s0 + w[i-7] + s1;
+    }
+    uint32_t a=h[0], b=h[1], c=h[2], d=h[3], e=h[4], f=h[5], g=h[6], hh=h[7];
+    for (int i = 0; i < 64; ++i) {
+      uint32_t S1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+      uint32_t ch = (e & f) ^ (~e & g);
+      uint32_t t1 = hh + S1 + ch + K[i] + w[i];
+      uint32_t S0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+      uint32_t mj = (a & b) ^ (a & c) ^ (b & c);
+      uint32_t t2 = S0 + mj;
+      hh = g; g = f; f = e; e = d + t1; d = c; c = b; b = a; a = t1 + t2;
+    }
+    h[0]+=a; h[1]+=b; h[2]+=c; h[3]+=d; h[4]+=e; h[5]+=f; h[6]+=g; h[7]+=hh;
+  }
+
+  void update(const uint8_t* p, size_t n) {
+    total += n;
+    if (bufLen) {
+      size_t take = std::min(n, sizeof(buf) - bufLen);
+      std::memcpy(buf + bufLen, p, take);
+      bufLen += take; p += take; n -= take;
+      if (bufLen < sizeof(buf)) return;
+      block(buf); bufLen = 0;
+    }
+    for (; n >= 64; p += 64, n -= 64) block(p);
+    if (n) { std::memcpy(buf, p, n); bufLen = n; }
+  }
+
+  Digest finish() {
+    const uint64_t bits = total * 8;
+    const uint8_t pad = 0x80;
+    update(&pad, 1);
+    const uint8_t zero = 0;
+    while (bufLen != 56) update(&zero, 1);
+    uint8_t len[8];
+    for (int i = 0; i < 8; ++i) len[i] = uint8_t(bits >> (56 - 8*i));
+    update(len, 8);
+    Digest out{};
+    for (int i = 0; i < 8; ++i) {
+      out[4*i]   = uint8_t(h[i] >> 24);
+      out[4*i+1] = uint8_t(h[i] >> 16);
+      out[4*i+2] = uint8_t(h[i] >> 8);
+      out[4*i+3] = uint8_t(h[i]);
+    }
+    return out;
+  }
+};
+
+int hexVal(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+} // namespace
+
+Digest sha256(std::string_view bytes) {
+  Sha256Ctx ctx;
+  ctx.update(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+  return ctx.finish();
+}
+
+std::string sha256Hex(std::string_view bytes) {
+  return toHex(sha256(bytes));
+}
+
+std::optional<Digest> sha256File(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) return std::nullopt;
+  Sha256Ctx ctx;
+  char buf[64 * 1024];
+  while (in) {
+    in.read(buf, sizeof(buf));
+    ctx.update(reinterpret_cast<const uint8_t*>(buf), static_cast<size_t>(in.gcount()));
+  }
+  if (in.bad()) return std::nullopt;
+  return ctx.finish();
+}
+
+Digest hmacSha256(std::string_view key, std::string_view message) {
+  uint8_t k[64] = {};
+  if (key.size() > sizeof(k)) {
+    Digest kd = sha256(key);
+    std::memcpy(k, kd.data(), kd.size());
+  } else {
+    std::memcpy(k, key.data(), key.size());
+  }
+  uint8_t ipad[64], opad[64];
+  for (int i = 0; i < 64; ++i) { ipad[i] = k[i] ^ 0x36; opad[i] = k[i] ^ 0x5c; }
+
+  Sha256Ctx inner;
+  inner.update(ipad, sizeof(ipad));
+  inner.update(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+  Digest ih = inner.finish();
+
+  Sha256Ctx outer;
+  outer.update(opad, sizeof(opad));
+  outer.update(ih.data(), ih.size());
+  return outer.finish();
+}
+
+std::string toHex(const Digest& d) {
+  static const char* k = "0123456789abcdef";
+  std::string out; out.resize(d.size() * 2);
+  for (size_t i = 0; i < d.size(); ++i) {
+    out[2*i]   = k[(d[i] >> 4) & 0xF];
+    out[2*i+1] = k[d[i] & 0xF];
+  }
+  return out;
+}
+
+Digest digestFromHex(std::string_view hex) {
+  if (hex.size() != 64) throw std::invalid_argument("sha256 hex must be 64 chars");
+  Digest out{};
+  for (size_t i = 0; i < out.size(); ++i) {
+    int hi = hexVal(hex[2*i]), lo = hexVal(hex[2*i+1]);
+    if (hi < 0 || lo < 0) throw std::invalid_argument("sha256 hex has non-hex chars");
+    out[i] = uint8_t((hi << 4) | lo);
+  }
+  return out;
+}
@@ -0,0 +1,24 @@
+// src/core/crypto/Hash.hpp
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Raw SHA-256 digest (32 bytes).
+using Digest = std::array<uint8_t, 32>;
+
+// Portable SHA-256 (FIPS 180-4); no platform crypto provider required.
+Digest sha256(std::string_view bytes);
+std::string sha256Hex(std::string_view bytes);
+
+// Streams a file through SHA-256; nullopt if it cannot be opened or read.
+std::optional<Digest> sha256File(const std::string& path);
+
+// HMAC-SHA256 (RFC 2104).
+Digest hmacSha256(std::string_view key, std::string_view message);
+
+// Lowercase hex <-> digest. digestFromHex throws on anything but 64 hex chars.
+std::string toHex(const Digest& d);
+Digest digestFromHex(std::string_view hex);
@@ -0,0 +1,405 @@
+// src/core/crypto/Sign.cpp
+#include "Sign.hpp"
+#include "core/metadata/MetadataStore.hpp"
+#include <sqlite3.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Prepared statement that finalizes itself; throws on prepare failure.
+struct Stmt {
+  sqlite3* db;
+  sqlite3_stmt* st = nullptr;
+  Stmt(sqlite3* d, const char* sql) : db(d) {
+    if (sqlite3_prepare_v2(db, sql, -1, &st, nullptr) != SQLITE_OK) {
+      throw std::runtime_error(std::string("prepare failed: ") + sqlite3_errmsg(db));
+    }
+  }
+  ~Stmt() { sqlite3_finalize(st); }
+  Stmt(const Stmt&) = delete;
+  Stmt& operator=(const Stmt&) = delete;
+
+  void reset() { sqlite3_reset(st); sqlite3_clear_bindings(st); }
+  void bind(int i, const std::string& s) { sqlite3_bind_text(st, i, s.c_str(), -1, SQLITE_TRANSIENT); }
+  void bind(int i, uint64_t v) { sqlite3_bind_int64(st, i, static_cast<sqlite3_int64>(v)); }
+  void bind(int i, int64_t v) { sqlite3_bind_int64(st, i, v); }
+  void bind(int i, const Digest& d) { sqlite3_bind_blob(st, i, d.data(), static_cast<int>(d.size()), SQLITE_TRANSIENT); }
+  Digest digest(int col) const {
+    Digest d{};
+    if (sqlite3_column_bytes(st, col) != static_cast<int>(d.size())) {
+      throw std::runtime_error("merkle: stored hash has wrong length");
+    }
+    const auto* p = static_cast<const uint8_t*>(sqlite3_column_blob(st, col));
+    std::copy(p, p + d.size(), d.begin());
+    return d;
+  }
+  void exec(const char* what) {
+    if (sqlite3_step(st) != SQLITE_DONE) {
+      throw std::runtime_error(std::string(what) + " failed: " + sqlite3_errmsg(db));
+    }
+  }
+};
+
+// Reads stored complete-subtree hashes for one mission.
+// Node (level, idx) covers leaves [idx << level, (idx + 1) << level).
+class NodeReader {
+public:
+  NodeReader(sqlite3* db, const std::string& mission_id)
+    : st_(db, "SELECT hash FROM merkle_nodes WHERE mission_id=? AND level=? AND idx=?"),
+      mission_id_(mission_id) {}
+
+  Digest get(int level, uint64_t idx) {
+    st_.reset();
+    st_.bind(1, mission_id_);
+    st_.bind(2, static_cast<int64_t>(level));
+    st_.bind(3, idx);
+    if (sqlite3_step(st_.st) != SQLITE_ROW) {
+      throw std::runtime_error("merkle: missing node");
+    }
+    return st_.digest(0);
+  }
+
+private:
+  Stmt st_;
+  std::string mission_id_;
+};
+
+// Largest power of two strictly less than n (n >= 2).
+uint64_t splitPoint(uint64_t n) {
+  uint64_t k = 1;
+  while ((k << 1) < n) k <<= 1;
+  return k;
+}
+
+// MTH(D[lo:hi]) per RFC 6962. Aligned power-of-two ranges are single lookups;
+// the ragged right edge decomposes into at most log2(n) of them.
+Digest subtreeHash(NodeReader& r, uint64_t lo, uint64_t hi) {
+  const uint64_t n = hi - lo;
+  if ((n & (n - 1)) == 0 && lo % n == 0) {
+    int level = 0;
+    while ((uint64_t(1) << level) < n) ++level;
+    return r.get(level, lo >> level);
+  }
+  const uint64_t k = splitPoint(n);
+  return merkleNodeHash(subtreeHash(r, lo, lo + k), subtreeHash(r, lo + k, hi));
+}
+
+Digest rootOf(NodeReader& r, uint64_t size) {
+  return size == 0 ? sha256("") : subtreeHash(r, 0, size);
+}
+
+// PATH(m, D[lo:hi]); m is relative to lo.
+void inclusionPath(NodeReader& r, uint64_t m, uint64_t lo, uint64_t hi, std::vector<Digest>& out) {
+  const uint64_t n = hi - lo;
+  if (n <= 1) return;
+  const uint64_t k = splitPoint(n);
+  if (m < k) {
+    inclusionPath(r, m, lo, lo + k, out);
+    out.push_back(subtreeHash(r, lo + k, hi));
+  } else {
+    inclusionPath(r, m - k, lo + k, hi, out);
+    out.push_back(subtreeHash(r, lo, lo + k));
+  }
+}
+
+// SUBPROOF(m, D[lo:hi], b); m is relative to lo.
+void consistencyPath(NodeReader& r, uint64_t m, uint64_t lo, uint64_t hi, bool b, std::vector<Digest>& out) {
+  const uint64_t n = hi - lo;
+  if (m == n) {
+    if (!b) out.push_back(subtreeHash(r, lo, hi));
+    return;
+  }
+  const uint64_t k = splitPoint(n);
+  if (m <= k) {
+    consistencyPath(r, m, lo, lo + k, b, out);
+    out.push_back(subtreeHash(r, lo + k, hi));
+  } else {
+    consistencyPath(r, m - k, lo + k, hi, false, out);
+    out.push_back(subtreeHash(r, lo, lo + k));
+  }
+}
+
+bool constantTimeEquals(const std::string& a, const std::string& b) {
+  if (a.size() != b.size()) return false;
+  unsigned char diff = 0;
+  for (size_t i = 0; i < a.size(); ++i) diff |= static_cast<unsigned char>(a[i] ^ b[i]);
+  return diff == 0;
+}
+
+} // namespace
+
+Digest merkleLeafHash(const Digest& object_sha256) {
+  std::string buf(1, '\x00');
+  buf.append(reinterpret_cast<const char*>(object_sha256.data()), object_sha256.size());
+  return sha256(buf);
+}
+
+Digest merkleNodeHash(const Digest& left, const Digest& right) {
+  std::string buf(1, '\x01');
+  buf.append(reinterpret_cast<const char*>(left.data()), left.size());
+  buf.append(reinterpret_cast<const char*>(right.data()), right.size());
+  return sha256(buf);
+}
+
+bool verifyInclusion(const Digest& leaf_hash, uint64_t leaf_index, uint64_t tree_size,
+                     const std::vector<Digest>& path, const Digest& root) {
+  if (leaf_index >= tree_size) return false;
+  uint64_t fn = leaf_index, sn = tree_size - 1;
+  Digest r = leaf_hash;
+  for (const auto& p : path) {
+    if (sn == 0) return false;
+    if ((fn & 1) || fn == sn) {
+      r = merkleNodeHash(p, r);
+      while (!(fn & 1) && fn != 0) { fn >>= 1; sn >>= 1; }
+    } else {
+      r = merkleNodeHash(r, p);
+    }
+    fn >>= 1; sn >>= 1;
+  }
+  return sn == 0 && r == root;
+}
+
+bool verifyConsistency(uint64_t old_size, const Digest& old_root,
+                       uint64_t new_size, const Digest& new_root,
+                       const std::vector<Digest>& proof) {
+  if (old_size == new_size) return proof.empty() && old_root == new_root;
+  if (old_size == 0 || old_size > new_size || proof.empty()) return false;
+
+  std::vector<Digest> c;
+  c.reserve(proof.size() + 1);
+  if ((old_size & (old_size - 1)) == 0) c.push_back(old_root);
+  c.insert(c.end(), proof.begin(), proof.end());
+
+  uint64_t fn = old_size - 1, sn = new_size - 1;
+  while (fn & 1) { fn >>= 1; sn >>= 1; }
+  Digest fr = c[0], sr = c[0];
+  for (size_t i = 1; i < c.size(); ++i) {
+    if (sn == 0) return false;
+    if ((fn & 1) || fn == sn) {
+      fr = merkleNodeHash(c[i], fr);
+      sr = merkleNodeHash(c[i], sr);
+      while (!(fn & 1) && fn != 0) { fn >>= 1; sn >>= 1; }
+    } else {
+      sr = merkleNodeHash(sr, c[i]);
+    }
+    fn >>= 1; sn >>= 1;
+  }
+  return sn == 0 && fr == old_root && sr == new_root;
+}
+
+MissionManifest::MissionManifest(MetadataStore& store, std::string signingKey)
+  : store_(store), key_(std::move(signingKey)) {}
+
+uint64_t MissionManifest::treeSize(const std::string& mission_id) const {
+  Stmt q(static_cast<sqlite3*>(store_.handle()),
+         "SELECT tree_size FROM mission_manifests WHERE mission_id=? ORDER BY tree_size DESC LIMIT 1");
+  q.bind(1, mission_id);
+  if (sqlite3_step(q.st) != SQLITE_ROW) return 0;
+  return static_cast<uint64_t>(sqlite3_column_int64(q.st, 0));
+}
+
+TreeHead MissionManifest::append(const std::string& mission_id,
+                                 const std::string& object_id,
+                                 const std::string& sha256_hex,
+                                 int64_t at) {
+  const Digest leaf = merkleLeafHash(digestFromHex(sha256_hex));
+
+  auto guard = store_.lock();
+  auto* db = static_cast<sqlite3*>(store_.handle());
+  execAll(db, "SAVEPOINT manifest_append;");
+  try {
+    const uint64_t n = treeSize(mission_id);
+
+    Stmt leafIns(db, "INSERT INTO merkle_leaves (mission_id, leaf_index, object_id) VALUES (?,?,?)");
+    leafIns.bind(1, mission_id);
+    leafIns.bind(2, n);
+    leafIns.bind(3, object_id);
+    leafIns.exec("merkle leaf insert");
+
+    // Write the leaf, then every subtree it completes (one per trailing 1-bit of n).
+    Stmt nodeIns(db, "INSERT INTO merkle_nodes (mission_id, level, idx, hash) VALUES (?,?,?,?)");
+    NodeReader reader(db, mission_id);
+    Digest cur = leaf;
+    uint64_t idx = n;
+    int level = 0;
+    for (;;) {
+      nodeIns.reset();
+      nodeIns.bind(1, mission_id);
+      nodeIns.bind(2, static_cast<int64_t>(level));
+      nodeIns.bind(3, idx);
+      nodeIns.bind(4, cur);
+      nodeIns.exec("merkle node insert");
+      if (!(idx & 1)) break;
+      cur = merkleNodeHash(reader.get(level, idx - 1), cur);
+      idx >>= 1;
+      ++level;
+    }
+
+    TreeHead th;
+    th.mission_id = mission_id;
+    th.tree_size  = n + 1;
+    th.root       = rootOf(reader, n + 1);
+    th.signed_at  = at;
+    th.signature  = sign(th);
+
+    Stmt headIns(db, R"SQL(
+      INSERT INTO mission_manifests (mission_id, tree_size, root_hash, signature, signed_at)
+      VALUES (?,?,?,?,?)
+    )SQL");
+    headIns.bind(1, th.mission_id);
+    headIns.bind(2, th.tree_size);
+    headIns.bind(3, th.root);
+    headIns.bind(4, th.signature);
+    headIns.bind(5, th.signed_at);
+    headIns.exec("manifest head insert");
+
+    execAll(db, "RELEASE manifest_append;");
+    return th;
+  } catch (...) {
+    sqlite3_exec(db, "ROLLBACK TO manifest_append; RELEASE manifest_append;", nullptr, nullptr, nullptr);
+    throw;
+  }
+}
+
+MissionManifest::BackfillReport MissionManifest::backfill(int64_t at) {
+  struct Pending {
+    int64_t created_at; int64_t rowid;
+    std::string id, mission_id, sha256, storage_path;
+    std::optional<Digest> actual;
+  };
+  if (key_.empty()) throw std::logic_error("manifest backfill requires a signing key");
+  auto guard = store_.lock();
+  auto* db = static_cast<sqlite3*>(store_.handle());
+
+  // Keyset pagination on (created_at, rowid) so skipped rows are not
+  // re-read forever.
+  Stmt q(db, R"SQL(
+    SELECT o.created_at, o.rowid, o.id, o.mission_id, o.sha256, o.storage_path
+    FROM objects o LEFT JOIN merkle_leaves l ON l.object_id = o.id
+    WHERE l.object_id IS NULL AND (o.created_at, o.rowid) > (?, ?)
+    ORDER BY o.created_at, o.rowid
+    LIMIT 1000
+  )SQL");
+  int64_t lastCreated = INT64_MIN, lastRowid = INT64_MIN;
+  BackfillReport report;
+  for (;;) {
+    std::vector<Pending> batch;
+    q.reset();
+    q.bind(1, lastCreated);
+    q.bind(2, lastRowid);
+    while (sqlite3_step(q.st) == SQLITE_ROW) {
+      auto text = [&](int col) {
+        auto* t = sqlite3_column_text(q.st, col);
+        return t ? std::string(reinterpret_cast<const char*>(t)) : std::string();
+      };
+      batch.push_back({sqlite3_column_int64(q.st, 0), sqlite3_column_int64(q.st, 1),
+                       text(2), text(3), text(4), text(5), std::nullopt});
+    }
+    q.reset();
+    if (batch.empty()) return report;
+
+    // Hash outside the write transaction; pre-upgrade rows may hold
+    // non-cryptographic placeholder digests.
+    for (auto& p : batch) {
+      if (!p.storage_path.empty()) p.actual = sha256File(p.storage_path);
+    }
+
+    store_.inTransaction([&] {
+      for (const auto& p : batch) {
+        if (!p.actual) { report.skipped.push_back(p.id); continue; }
+        const std::string hex = toHex(*p.actual);
+        if (hex != p.sha256) {
+          store_.updateSha256(p.id, hex, at);
+          store_.appendHistory(p.id, "REHASHED",
+                               nlohmann::json{{"old_sha256", p.sha256}, {"source", "manifest-backfill"}}.dump(),
+                               at, "system");
+          ++report.rehashed;
+        }
+        append(p.mission_id, p.id, hex, at);
+        ++report.appended;
+      }
+    });
+    lastCreated = batch.back().created_at;
+    lastRowid   = batch.back().rowid;
+  }
+}
+
+std::optional<TreeHead> MissionManifest::head(const std::string& mission_id, uint64_t tree_size) const {
+  auto guard = store_.lock();
+  auto* db = static_cast<sqlite3*>(store_.handle());
+  const char* sql = tree_size == 0
+    ? "SELECT tree_size, root_hash, signature, signed_at FROM mission_manifests "
+      "WHERE mission_id=? ORDER BY tree_size DESC LIMIT 1"
+    : "SELECT tree_size, root_hash, signature, signed_at FROM mission_manifests "
+      "WHERE mission_id=? AND tree_size=?";
+  Stmt q(db, sql);
+  q.bind(1, mission_id);
+  if (tree_size != 0) q.bind(2, tree_size);
+  if (sqlite3_step(q.st) != SQLITE_ROW) return std::nullopt;
+
+  TreeHead th;
+  th.mission_id = mission_id;
+  th.tree_size  = static_cast<uint64_t>(sqlite3_column_int64(q.st, 0));
+  th.root       = q.digest(1);
+  if (auto* s = sqlite3_column_text(q.st, 2)) th.signature = reinterpret_cast<const char*>(s);
+  th.signed_at  = sqlite3_column_int64(q.st, 3);
+  return th;
+}
+
+InclusionProof MissionManifest::inclusionProof(const std::string& mission_id,
+                                               const std::string& object_id,
+                                               uint64_t tree_size) const {
+  auto guard = store_.lock();
+  auto* db = static_cast<sqlite3*>(store_.handle());
+  const uint64_t current = treeSize(mission_id);
+  if (tree_size == 0) tree_size = current;
+  if (tree_size == 0 || tree_size > current) {
+    throw std::out_of_range("no manifest of that size for mission");
+  }
+
+  Stmt q(db, "SELECT leaf_index FROM merkle_leaves WHERE object_id=? AND mission_id=?");
+  q.bind(1, object_id);
+  q.bind(2, mission_id);
+  if (sqlite3_step(q.st) != SQLITE_ROW) throw std::out_of_range("object not in mission manifest");
+  const auto index = static_cast<uint64_t>(sqlite3_column_int64(q.st, 0));
+  if (index >= tree_size) throw std::out_of_range("object appended after requested tree size");
+
+  NodeReader reader(db, mission_id);
+  InclusionProof p;
+  p.leaf_index = index;
+  p.tree_size  = tree_size;
+  p.leaf_hash  = reader.get(0, index);
+  inclusionPath(reader, index, 0, tree_size, p.path);
+  return p;
+}
+
+std::vector<Digest> MissionManifest::consistencyProof(const std::string& mission_id,
+                                                      uint64_t old_size,
+                                                      uint64_t new_size) const {
+  auto guard = store_.lock();
+  if (old_size == 0 || old_size > new_size || new_size > treeSize(mission_id)) {
+    throw std::out_of_range("invalid manifest sizes for consistency proof");
+  }
+  std::vector<Digest> out;
+  if (old_size == new_size) return out;
+  NodeReader reader(static_cast<sqlite3*>(store_.handle()), mission_id);
+  consistencyPath(reader, old_size, 0, new_size, true, out);
+  return out;
+}
+
+std::string MissionManifest::sign(const TreeHead& th) const {
+  if (key_.empty()) return {};
+  const std::string msg = "mdm-manifest-v1\n" + th.mission_id + "\n" +
+                          std::to_string(th.tree_size) + "\n" + toHex(th.root) + "\n" +
+                          std::to_string(th.signed_at);
+  return toHex(hmacSha256(key_, msg));
+}
+
+bool MissionManifest::verifySignature(const TreeHead& th) const {
+  if (key_.empty() || th.signature.empty()) return false;
+  return constantTimeEquals(sign(th), th.signature);
+}
@@ -0,0 +1,98 @@
+// src/core/crypto/Sign.hpp
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Hash.hpp"
+
+class MetadataStore;
+
+// One version of a mission manifest: the Merkle root over the first
+// tree_size objects appended to that mission, plus its signature.
+struct TreeHead {
+  std::string mission_id;
+  uint64_t    tree_size = 0;
+  Digest      root{};
+  int64_t     signed_at = 0;
+  std::string signature;   // hex HMAC-SHA256; empty when signing is disabled
+};
+
+struct InclusionProof {
+  uint64_t            leaf_index = 0;
+  uint64_t            tree_size = 0;
+  Digest              leaf_hash{};
+  std::vector<Digest> path;      // sibling hashes, leaf -> root
+};
+
+// Merkle hashing with RFC 6962 domain separation (0x00 leaf, 0x01 node).
+// The leaf input is the raw 32-byte object sha256.
+Digest merkleLeafHash(const Digest& object_sha256);
+Digest merkleNodeHash(const Digest& left, const Digest& right);
+
+// Stateless verifiers (RFC 9162 2.1.3.2 / 2.1.4.2); need no DB access.
+bool verifyInclusion(const Digest& leaf_hash, uint64_t leaf_index, uint64_t tree_size,
+                     const std::vector<Digest>& path, const Digest& root);
+bool verifyConsistency(uint64_t old_size, const Digest& old_root,
+                       uint64_t new_size, const Digest& new_root,
+                       const std::vector<Digest>& proof);
+
+// Append-only per-mission Merkle manifest persisted in SQLite
+// (tables merkle_nodes / merkle_leaves / mission_manifests).
+// Only complete subtrees are stored, so an append writes O(log n) nodes and
+// roots/proofs for any past tree size are served from O(log n) node reads.
+// Uses the MetadataStore's connection and lock, so an append can join the
+// transaction that inserts the object row.
+class MissionManifest {
+public:
+  // Empty signingKey = signing disabled (heads are stored unsigned).
+  MissionManifest(MetadataStore& store, std::string signingKey);
+  MissionManifest(const MissionManifest&) = delete;
+  MissionManifest& operator=(const MissionManifest&) = delete;
+
+  // Adds object_id (with its hex sha256) as the next leaf of the mission's
+  // tree and records a new signed head. Throws if the object is already present.
+  // Runs in a savepoint: atomic on its own, or part of the caller's transaction.
+  TreeHead append(const std::string& mission_id,
+                  const std::string& object_id,
+                  const std::string& sha256_hex,
+                  int64_t at);
+
+  struct BackfillReport {
+    uint64_t appended = 0;
+    uint64_t rehashed = 0;             // stored sha256 differed from the file and was corrected
+    std::vector<std::string> skipped;  // ids whose bytes could not be read; not appended
+  };
+
+  // Appends every object that has no leaf yet (e.g. ingested before manifests
+  // existed), oldest created_at first, in batches of one transaction each.
+  // Stored digests are not trusted: each digest is re-derived from the bytes at
+  // storage_path, and objects whose bytes cannot be read are skipped, not signed.
+  // Backfilled objects land after the mission's existing leaves. Idempotent.
+  // Throws std::logic_error when signing is disabled: unsigned backfilled
+  // heads could never be signed later.
+  BackfillReport backfill(int64_t at);
+
+  // tree_size == 0 selects the latest head.
+  std::optional<TreeHead> head(const std::string& mission_id, uint64_t tree_size = 0) const;
+
+  // Proof that object_id is in the mission tree of the given size (0 = latest).
+  InclusionProof inclusionProof(const std::string& mission_id,
+                                const std::string& object_id,
+                                uint64_t tree_size = 0) const;
+
+  // Proof that the tree of old_size is a prefix of the tree of new_size.
+  std::vector<Digest> consistencyProof(const std::string& mission_id,
+                                       uint64_t old_size,
+                                       uint64_t new_size) const;
+
+  bool verifySignature(const TreeHead& th) const;
+
+private:
+  std::string sign(const TreeHead& th) const;
+  uint64_t treeSize(const std::string& mission_id) const;
+
+  MetadataStore& store_;
+  std::string key_;
+};
@@ -1,20 +1,12 @@
 // src/core/metadata/InitDb.cpp
 #include "InitDb.hpp"
+#include "MetadataStore.hpp"
 #include <sqlite3.h>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 
-static void execAll(sqlite3* db, const std::string& sql) {
-    char* err = nullptr;
-    if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &err) != SQLITE_OK) {
-        std::string msg = err ? err : "unknown error";
-        sqlite3_free(err);
-        throw std::runtime_error("SQLite exec failed: " + msg);
-    }
-}
-
 bool initDatabase(const std::string& dbPath, const std::string& schemaPath) {
     std::filesystem::create_directories(std::filesystem::path(dbPath).parent_path());
 
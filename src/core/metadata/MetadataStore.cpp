@@ -2,15 +2,31 @@
 #include <stdexcept>
 #include <sqlite3.h>
 
+void execAll(sqlite3* db, const std::string& sql) {
+  char* err = nullptr;
+  if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &err) != SQLITE_OK) {
+    std::string msg = err ? err : "unknown error";
+    sqlite3_free(err);
+    throw std::runtime_error("SQLite exec failed: " + msg);
+  }
+}
+
 MetadataStore::MetadataStore(const std::string& dbPath) : db_(nullptr) {
   sqlite3* db=nullptr;
   if (sqlite3_open_v2(dbPath.c_str(), &db, SQLITE_OPEN_READWRITE, nullptr)!=SQLITE_OK) {
+    sqlite3_close(db);
     throw std::runtime_error("failed to open db");
   }
+  sqlite3_busy_timeout(db, 5000);
   db_ = db;
 }
 
+MetadataStore::~MetadataStore() {
+  sqlite3_close(static_cast<sqlite3*>(db_));
+}
+
 void MetadataStore::insertObject(const ObjectRecord& r) {
+  auto guard = lock();
   auto* db = static_cast<sqlite3*>(db_);
   const char* sql = R"SQL(
     INSERT INTO objects
@@ -48,11 +64,41 @@ void MetadataStore::insertObject(const ObjectRecord& r) {
   sqlite3_finalize(st);
 }
 
+bool MetadataStore::objectExists(const std::string& id) const {
+  auto guard = lock();
+  auto* db = static_cast<sqlite3*>(db_);
+  sqlite3_stmt* st=nullptr;
+  if (sqlite3_prepare_v2(db, "SELECT 1 FROM objects WHERE id=?", -1, &st, nullptr) != SQLITE_OK) {
+    throw std::runtime_error(std::string("objectExists failed: ") + sqlite3_errmsg(db));
+  }
+  sqlite3_bind_text(st, 1, id.c_str(), -1, SQLITE_TRANSIENT);
+  const bool found = sqlite3_step(st) == SQLITE_ROW;
+  sqlite3_finalize(st);
+  return found;
+}
+
+void MetadataStore::updateSha256(const std::string& id, const std::string& sha256, int64_t at) {
+  auto guard = lock();
+  auto* db = static_cast<sqlite3*>(db_);
+  sqlite3_stmt* st=nullptr;
+  sqlite3_prepare_v2(db, "UPDATE objects SET sha256=?, updated_at=? WHERE id=?", -1, &st, nullptr);
+  sqlite3_bind_text(st, 1, sha256.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int64(st, 2, at);
+  sqlite3_bind_text(st, 3, id.c_str(), -1, SQLITE_TRANSIENT);
+  if (sqlite3_step(st) != SQLITE_DONE) {
+    std::string err = sqlite3_errmsg(db);
+    sqlite3_finalize(st);
+    throw std::runtime_error("updateSha256 failed: " + err);
+  }
+  sqlite3_finalize(st);
+}
+
 void MetadataStore::appendHistory(const std::string& object_id,
                                   const std::string& event,
                                   const std::string& details_json,
                                   int64_t at,
                                   const std::string& actor) {
+  auto guard = lock();
   auto* db = static_cast<sqlite3*>(db_);
   const char* sql = R"SQL(
     INSERT INTO object_history (object_id, event, details, at, actor)
@@ -72,3 +118,16 @@ void MetadataStore::appendHistory(const std::string& object_id,
   }
   sqlite3_finalize(st);
 }
+
+void MetadataStore::inTransaction(const std::function<void()>& fn) {
+  auto guard = lock();
+  auto* db = static_cast<sqlite3*>(db_);
+  execAll(db, "BEGIN IMMEDIATE;");
+  try {
+    fn();
+    execAll(db, "COMMIT;");
+  } catch (...) {
+    sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+    throw;
+  }
+}
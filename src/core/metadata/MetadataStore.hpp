@@ -1,6 +1,14 @@
 #pragma once
 #include <string>
 #include <optional>
+#include <functional>
+#include <mutex>
+
+struct sqlite3;
+
+// Runs one or more SQL statements on db; throws std::runtime_error with
+// SQLite's message on failure. Shared by InitDb, MetadataStore and Sign.
+void execAll(sqlite3* db, const std::string& sql);
 
 struct ObjectRecord {
   std::string id;
@@ -24,16 +32,36 @@ struct ObjectRecord {
   std::string pipeline_run_id;
 };
 
+// Concurrency model: one SQLite connection per process, shared by every core
+// component that writes the DB (MissionManifest borrows it via handle()).
+// All use of the connection is serialized by lock(), so a transaction opened
+// by one HTTP worker never interleaves with another worker's statements.
+// busy_timeout covers other processes (mdm --init, sqlite3 CLI).
 class MetadataStore {
 public:
   explicit MetadataStore(const std::string& dbPath);
+  ~MetadataStore();
+  MetadataStore(const MetadataStore&) = delete;
+  MetadataStore& operator=(const MetadataStore&) = delete;
+
   void insertObject(const ObjectRecord& r);
+  bool objectExists(const std::string& id) const;
+  void updateSha256(const std::string& id, const std::string& sha256, int64_t at);
   void appendHistory(const std::string& object_id,
                      const std::string& event,
                      const std::string& details_json,
                      int64_t at,
                      const std::string& actor);
+  // Runs fn inside one BEGIN IMMEDIATE..COMMIT while holding lock();
+  // rolls everything back and rethrows if fn throws.
+  void inTransaction(const std::function<void()>& fn);
   // ...existing APIs...
+
+  // Raw sqlite3* for components sharing this connection; hold lock() while using it.
+  void* handle() const { return db_; }
+  std::unique_lock<std::recursive_mutex> lock() const { return std::unique_lock(mu_); }
+
 private:
   void* db_; // sqlite3*
+  mutable std::recursive_mutex mu_;
 };
@@ -32,7 +32,7 @@ CREATE TABLE IF NOT EXISTS objects (
 CREATE TABLE IF NOT EXISTS object_history (
   id         INTEGER PRIMARY KEY AUTOINCREMENT,
   object_id  TEXT NOT NULL,
-  event      TEXT NOT NULL,                      -- CREATED|MIGRATED|TAGGED|ACCESSED|DELETED
+  event      TEXT NOT NULL,                      -- CREATED|MIGRATED|TAGGED|ACCESSED|DELETED|REHASHED
   details    JSON,                               -- freeform
   at         INTEGER NOT NULL,
   actor      TEXT,                               -- api key, system, username
@@ -49,8 +49,38 @@ CREATE TABLE IF NOT EXISTS object_links (
   FOREIGN KEY (child_id) REFERENCES objects(id) ON DELETE CASCADE
 );
 
+-- merkle_nodes = per-mission append-only Merkle tree over object sha256s (chain of custody).
+-- Only complete subtrees are stored: (level, idx) covers leaves [idx*2^level, (idx+1)*2^level).
+-- Appending a leaf writes at most log2(n)+1 rows; nodes are never updated.
+CREATE TABLE IF NOT EXISTS merkle_nodes (
+  mission_id TEXT    NOT NULL,
+  level      INTEGER NOT NULL,                   -- 0 = leaf hash
+  idx        INTEGER NOT NULL,
+  hash       BLOB    NOT NULL,                   -- 32-byte sha256
+  PRIMARY KEY (mission_id, level, idx)
+) WITHOUT ROWID;
+
+-- merkle_leaves = leaf position of each object in its mission tree (for inclusion proofs)
+CREATE TABLE IF NOT EXISTS merkle_leaves (
+  mission_id TEXT    NOT NULL,
+  leaf_index INTEGER NOT NULL,
+  object_id  TEXT    NOT NULL UNIQUE,            -- no FK: the manifest outlives deleted objects
+  PRIMARY KEY (mission_id, leaf_index)
+) WITHOUT ROWID;
+
+-- mission_manifests = signed tree head per manifest version (one per append)
+CREATE TABLE IF NOT EXISTS mission_manifests (
+  mission_id TEXT    NOT NULL,
+  tree_size  INTEGER NOT NULL,
+  root_hash  BLOB    NOT NULL,                   -- 32-byte Merkle root
+  signature  TEXT,                               -- hex HMAC-SHA256 over the head; NULL/empty if unsigned
+  signed_at  INTEGER NOT NULL,
+  PRIMARY KEY (mission_id, tree_size)
+) WITHOUT ROWID;
+
 -- Indexes
 CREATE INDEX IF NOT EXISTS idx_objects_mission        ON objects(mission_id);
+CREATE INDEX IF NOT EXISTS idx_objects_created        ON objects(created_at);   -- manifest backfill order
 CREATE INDEX IF NOT EXISTS idx_objects_tier           ON objects(storage_tier);
 CREATE INDEX IF NOT EXISTS idx_objects_type           ON objects(object_type);
 CREATE INDEX IF NOT EXISTS idx_objects_capture_time   ON objects(capture_time);
@@ -1,6 +1,9 @@
 #include "LocalFSBackend.hpp"
 #include <filesystem>
 #include <fstream>
+#include <random>
+#include <stdexcept>
+#include <spdlog/spdlog.h>
 
 std::string LocalFSBackend::put(const std::string& mission_id,
                                 const std::string& id,
@@ -14,3 +17,36 @@ std::string LocalFSBackend::put(const std::string& mission_id,
   os.flush();
   return fs::weakly_canonical(file).string();
 }
+
+std::string LocalFSBackend::pathFor(const std::string& mission_id,
+                                    const std::string& id) const {
+  namespace fs = std::filesystem;
+  return fs::weakly_canonical(fs::path(hotRoot_) / mission_id / id).string();
+}
+
+std::string LocalFSBackend::stage(const std::string& mission_id,
+                                  const std::string& id,
+                                  std::string_view bytes) {
+  namespace fs = std::filesystem;
+  static thread_local std::mt19937_64 rng{std::random_device{}()};
+  fs::path dir = fs::path(hotRoot_) / mission_id;
+  fs::create_directories(dir);
+  fs::path file = dir / ("." + id + ".staging-" + std::to_string(rng()));
+  std::ofstream os(file, std::ios::binary);
+  os.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  os.flush();
+  if (!os) throw std::runtime_error("failed to write staged file " + file.string());
+  return fs::weakly_canonical(file).string();
+}
+
+void LocalFSBackend::promote(const std::string& staged, const std::string& final_path) {
+  namespace fs = std::filesystem;
+  fs::rename(fs::path(staged), fs::path(final_path));
+}
+
+void LocalFSBackend::remove(const std::string& path) {
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  fs::remove(fs::path(path), ec);
+  if (ec) spdlog::warn("failed to remove {} (orphaned file): {}", path, ec.message());
+}
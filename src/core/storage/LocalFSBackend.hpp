@@ -12,6 +12,22 @@ public:
                   const std::string& id,
                   std::string_view bytes);
 
+  // Final HOT path for mission_id/id (no I/O).
+  std::string pathFor(const std::string& mission_id, const std::string& id) const;
+
+  // Writes bytes to a unique temp file beside pathFor(mission_id, id) and
+  // returns its path. Nothing at the final path is touched until promote().
+  std::string stage(const std::string& mission_id,
+                    const std::string& id,
+                    std::string_view bytes);
+
+  // Moves a staged file onto its final path (call after metadata commits).
+  void promote(const std::string& staged, const std::string& final_path);
+
+  // Deletes a file this process created (e.g. a staged file whose metadata
+  // insert failed); missing files are ignored, other failures are logged.
+  void remove(const std::string& path);
+
 private:
   std::string hotRoot_;
   std::string coldRoot_;
@@ -1,5 +1,6 @@
 // src/main.cpp
 #include <cstdlib>
+#include <ctime>
 #include <string>
 #include <iostream>
 #include <filesystem>
@@ -8,6 +9,7 @@
 #include "core/metadata/InitDb.hpp"
 #include "core/metadata/MetadataStore.hpp"
 #include "core/storage/LocalFSBackend.hpp"
+#include "core/crypto/Sign.hpp"
 #include "services/api/HttpServer.hpp"
 
 // ---------- helpers ----------
@@ -61,8 +63,9 @@ static void ensure_dirs_for(const std::string& file_path) {
 
 static void print_usage(const char* argv0) {
   std::cout << "Usage:\n"
-            << "  " << argv0 << " --init        # create/upgrade SQLite schema\n"
-            << "  " << argv0 << " --serve       # start HTTP server (MDM_PORT or 8080)\n";
+            << "  " << argv0 << " --init                # create/upgrade SQLite schema\n"
+            << "  " << argv0 << " --backfill-manifests  # add pre-existing objects to mission manifests (needs MDM_MANIFEST_KEY)\n"
+            << "  " << argv0 << " --serve               # start HTTP server (MDM_PORT or 8080)\n";
 }
 
 // ---------- main ----------
@@ -78,6 +81,31 @@ int main(int argc, char** argv) {
       return 0;
     }
 
+    if (argc > 1 && std::string(argv[1]) == "--backfill-manifests") {
+      // Explicit, one-shot: heads written here can never be re-signed, so a key is mandatory
+      const std::string signingKey = get_env_or("MDM_MANIFEST_KEY", "");
+      if (signingKey.empty()) {
+        std::cerr << "MDM_MANIFEST_KEY must be set to backfill mission manifests\n";
+        return 1;
+      }
+      const std::string dbPath = defaultDbPath();
+      const std::string schemaPath = findSchemaPath();
+      ensure_dirs_for(dbPath);
+      initDatabase(dbPath, schemaPath);
+
+      MetadataStore store(dbPath);
+      MissionManifest manifest(store, signingKey);
+      const auto report = manifest.backfill(static_cast<int64_t>(std::time(nullptr)));
+      std::cout << "Manifest backfill: " << report.appended << " appended, "
+                << report.rehashed << " digest(s) corrected, "
+                << report.skipped.size() << " skipped (bytes unreadable)\n";
+      for (size_t i = 0; i < report.skipped.size() && i < 20; ++i) {
+        std::cout << "  skipped: " << report.skipped[i] << "\n";
+      }
+      if (report.skipped.size() > 20) std::cout << "  ...\n";
+      return 0;
+    }
+
     if (argc > 1 && std::string(argv[1]) == "--serve") {
       // Self-heal DB on startup (idempotent)
       const std::string dbPath = defaultDbPath();
@@ -94,13 +122,14 @@ int main(int argc, char** argv) {
       // Construct services
       MetadataStore store(dbPath);
       LocalFSBackend fs(hotRoot, coldRoot);
+      MissionManifest manifest(store, get_env_or("MDM_MANIFEST_KEY", "")); // empty = heads unsigned
 
       // Port + (optional) API key
       const int port = envPortOrDefault();
       const std::string apiKey = get_env_or("MDM_API_KEY", ""); // empty = auth disabled (early integration)
 
       // Start server (expects the expanded signature)
-      mdm::run_http_server(store, fs, port, apiKey);
+      mdm::run_http_server(store, fs, manifest, port, apiKey);
       return 0;
     }
 
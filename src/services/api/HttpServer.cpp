@@ -4,69 +4,19 @@
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 #include <ctime>
+#include <optional>
 #include <random>
 #include <string>
 #include <utility>
 #include <vector>
-#include <sstream>
 
 #include "core/metadata/MetadataStore.hpp"
 #include "core/storage/LocalFSBackend.hpp"
-
-// -------- SHA-256 (Windows CNG) --------
-#ifdef _WIN32
-  #include <windows.h>
-  #include <bcrypt.h>
-  #pragma comment(lib, "bcrypt")
-#endif
+#include "core/crypto/Hash.hpp"
+#include "core/crypto/Sign.hpp"
 
 using nlohmann::json;
 
-static std::string to_hex(const uint8_t* data, size_t len) {
-  static const char* k = "0123456789abcdef";
-  std::string out; out.resize(len * 2);
-  for (size_t i = 0; i < len; ++i) {
-    out[2*i]   = k[(data[i] >> 4) & 0xF];
-    out[2*i+1] = k[data[i] & 0xF];
-  }
-  return out;
-}
-
-static std::string sha256_hex(std::string_view bytes) {
-#ifdef _WIN32
-  BCRYPT_ALG_HANDLE hAlg = nullptr;
-  BCRYPT_HASH_HANDLE hHash = nullptr;
-  NTSTATUS st = BCryptOpenAlgorithmProvider(&hAlg, BCRYPT_SHA256_ALGORITHM, nullptr, 0);
-  if (st < 0) throw std::runtime_error("BCryptOpenAlgorithmProvider failed");
-  DWORD objLen = 0, cb = 0, hashLen = 0;
-  st = BCryptGetProperty(hAlg, BCRYPT_OBJECT_LENGTH, (PUCHAR)&objLen, sizeof(objLen), &cb, 0);
-  if (st < 0) { BCryptCloseAlgorithmProvider(hAlg, 0); throw std::runtime_error("GetProp OBJ_LEN failed"); }
-  st = BCryptGetProperty(hAlg, BCRYPT_HASH_LENGTH, (PUCHAR)&hashLen, sizeof(hashLen), &cb, 0);
-  if (st < 0) { BCryptCloseAlgorithmProvider(hAlg, 0); throw std::runtime_error("GetProp HASH_LEN failed"); }
-  std::vector<uint8_t> obj(objLen), hash(hashLen);
-  st = BCryptCreateHash(hAlg, &hHash, obj.data(), objLen, nullptr, 0, 0);
-  if (st < 0) { BCryptCloseAlgorithmProvider(hAlg, 0); throw std::runtime_error("CreateHash failed"); }
-  if (!bytes.empty()) {
-    st = BCryptHashData(hHash, (PUCHAR)bytes.data(), (ULONG)bytes.size(), 0);
-    if (st < 0) { BCryptDestroyHash(hHash); BCryptCloseAlgorithmProvider(hAlg, 0); throw std::runtime_error("HashData failed"); }
-  }
-  st = BCryptFinishHash(hHash, hash.data(), (ULONG)hash.size(), 0);
-  BCryptDestroyHash(hHash);
-  BCryptCloseAlgorithmProvider(hAlg, 0);
-  if (st < 0) throw std::runtime_error("FinishHash failed");
-  return to_hex(hash.data(), hash.size());
-#else
-  // Fallback (non-Windows) — TODO: replace with OpenSSL or std::sha256 when available
-  std::hash<std::string_view> h; // NOT cryptographic, placeholder only
-  size_t v = h(bytes);
-  std::ostringstream oss; oss << std::hex << v;
-  auto s = oss.str();
-  // pad to 64 hex chars to satisfy NOT NULL constraint
-  if (s.size() < 64) s.append(64 - s.size(), '0');
-  return s;
-#endif
-}
-
 // -------- helpers --------
 
 static std::string uuid4() {
@@ -108,12 +58,41 @@ static std::string param_or(const httplib::Request& req, const char* k, const st
   return def;
 }
 
+static json tree_head_json(const TreeHead& th) {
+  return json{
+    {"mission_id", th.mission_id},
+    {"tree_size",  th.tree_size},
+    {"root",       toHex(th.root)},
+    {"signature",  th.signature},
+    {"signed_at",  th.signed_at}
+  };
+}
+
+static json digests_json(const std::vector<Digest>& ds) {
+  json out = json::array();
+  for (const auto& d : ds) out.push_back(toHex(d));
+  return out;
+}
+
+// Manifest size params: absent -> nullopt; present -> must be a positive decimal.
+// Sets ok=false on anything else so the caller can answer 422 instead of
+// silently serving a different manifest version.
+static std::optional<uint64_t> param_size(const httplib::Request& req, const char* k, bool& ok) {
+  const auto s = param_or(req, k);
+  if (s.empty()) return std::nullopt;
+  if (s.size() > 19 || s.find_first_not_of("0123456789") != std::string::npos) { ok = false; return std::nullopt; }
+  const uint64_t v = std::stoull(s);
+  if (v == 0) { ok = false; return std::nullopt; }
+  return v;
+}
+
 // -------- server --------
 
 namespace mdm {
 
 void run_http_server(MetadataStore& store,
                      LocalFSBackend& fs,
+                     MissionManifest& manifest,
                      int port,
                      const std::string& apiKey) {
   httplib::Server svr;
@@ -184,11 +163,24 @@ void run_http_server(MetadataStore& store,
     const std::string pipeline_run_id = get_s("pipeline_run_id", "");
     const json        tags            = get_json_obj("tags");
 
-    const std::string sha256 = sha256_hex(std::string_view(bytes));
+    const std::string sha256 = sha256Hex(std::string_view(bytes));
     const int64_t now = static_cast<int64_t>(std::time(nullptr));
 
-    // Write to HOT storage and persist metadata
-    const std::string storage_path = fs.put(mission_id, id, std::string_view(bytes));
+    // A client-supplied id must not clobber an existing object's bytes
+    if (store.objectExists(id)) {
+      res.status = 409; res.set_content("object id already exists", "text/plain"); return;
+    }
+
+    // Stage bytes beside the HOT path; they are moved into place only after
+    // the metadata commits, so a failed request never touches stored objects.
+    const std::string storage_path = fs.pathFor(mission_id, id);
+    std::string staged;
+    try {
+      staged = fs.stage(mission_id, id, std::string_view(bytes));
+    } catch (const std::exception& e) {
+      spdlog::error("staging failed: {}", e.what());
+      res.status = 500; res.set_content("write failed", "text/plain"); return;
+    }
 
     ObjectRecord rec {
       /*id*/             id,
@@ -210,21 +202,40 @@ void run_http_server(MetadataStore& store,
       /*pipeline_run_id*/pipeline_run_id
     };
 
+    // Object row, history and manifest leaf commit together or not at all
+    TreeHead head;
     try {
-      store.insertObject(rec);
-      store.appendHistory(id, "CREATED", json({{"source","/ingest"}}).dump(), now, "api");
+      store.inTransaction([&] {
+        store.insertObject(rec);
+        store.appendHistory(id, "CREATED", json({{"source","/ingest"}}).dump(), now, "api");
+        head = manifest.append(mission_id, id, sha256, now);
+      });
     } catch (const std::exception& e) {
+      fs.remove(staged);
+      if (store.objectExists(id)) {   // lost a race with a concurrent request for the same id
+        res.status = 409; res.set_content("object id already exists", "text/plain"); return;
+      }
       spdlog::error("insert failed: {}", e.what());
       res.status = 500;
       res.set_content("insert failed", "text/plain");
       return;
     }
 
+    try {
+      fs.promote(staged, storage_path);
+    } catch (const std::exception& e) {
+      spdlog::error("object {} committed but its bytes are still at {}: {}", id, staged, e.what());
+      res.status = 500;
+      res.set_content("stored metadata but failed to place file", "text/plain");
+      return;
+    }
+
     json out = {
       {"id", id},
       {"sha256", sha256},
       {"storage_tier", "HOT"},
-      {"storage_path", storage_path}
+      {"storage_path", storage_path},
+      {"manifest", tree_head_json(head)}
     };
     res.status = 200;
     res.set_content(out.dump(), "application/json");
@@ -284,6 +295,12 @@ void run_http_server(MetadataStore& store,
   const int64_t     size_bytes     = get_i64("size_bytes", 0);
   const std::string sha256         = get_s("sha256", "");       // optional; may be blank
   const json        tags           = get_obj("tags");
+
+  // Only objects with a real digest can join the mission manifest
+  if (!sha256.empty()) {
+      try { digestFromHex(sha256); }
+      catch (...) { res.status = 422; res.set_content("metadata.sha256 must be 64 hex chars", "text/plain"); return; }
+  }
  
   // Build a DB record without putting bytes into HOT storage
   const int64_t now = static_cast<int64_t>(std::time(nullptr));
@@ -307,9 +324,13 @@ void run_http_server(MetadataStore& store,
       /*pipeline_run_id*/pipeline_run_id
   };
  
+  std::optional<TreeHead> head;
   try {
-      store.insertObject(rec);
-      store.appendHistory(id, "INDEXED", json({{"source","/ingest/meta"}}).dump(), now, "api");
+      store.inTransaction([&] {
+          store.insertObject(rec);
+          store.appendHistory(id, "INDEXED", json({{"source","/ingest/meta"}}).dump(), now, "api");
+          if (!sha256.empty()) head = manifest.append(mission_id, id, sha256, now);
+      });
   } catch (const std::exception& e) {
       spdlog::error("insert failed (/ingest/meta): {}", e.what());
       res.status = 500; res.set_content("insert failed", "text/plain"); return;
@@ -320,10 +341,87 @@ void run_http_server(MetadataStore& store,
       {"storage_tier", storage_tier},
       {"storage_path", storage_path}
   };
+  if (head) out["manifest"] = tree_head_json(*head);
   res.status = 200;
   res.set_content(out.dump(), "application/json");
   });
 
+  // GET /missions/<mission_id>/manifest[?tree_size=N]
+  // Signed tree head (Merkle root over object sha256s); latest when tree_size is omitted.
+  svr.Get(R"(/missions/([^/]+)/manifest)", [&](const httplib::Request& req, httplib::Response& res) {
+    if (!check_api_key(req, apiKey, res)) return;
+    bool ok = true;
+    const auto tree_size = param_size(req, "tree_size", ok);
+    if (!ok) { res.status = 422; res.set_content("tree_size must be a positive integer", "text/plain"); return; }
+    auto head = manifest.head(req.matches[1].str(), tree_size.value_or(0));
+    if (!head) { res.status = 404; res.set_content("no manifest", "text/plain"); return; }
+    res.status = 200;
+    res.set_content(tree_head_json(*head).dump(), "application/json");
+  });
+
+  // GET /missions/<mission_id>/manifest/inclusion?object_id=<id>[&tree_size=N]
+  // Audit path proving one object is covered by the root of tree_size.
+  svr.Get(R"(/missions/([^/]+)/manifest/inclusion)", [&](const httplib::Request& req, httplib::Response& res) {
+    if (!check_api_key(req, apiKey, res)) return;
+    const std::string object_id = param_or(req, "object_id");
+    if (object_id.empty()) { res.status = 422; res.set_content("object_id required", "text/plain"); return; }
+    bool ok = true;
+    const auto tree_size = param_size(req, "tree_size", ok);
+    if (!ok) { res.status = 422; res.set_content("tree_size must be a positive integer", "text/plain"); return; }
+    try {
+      auto p = manifest.inclusionProof(req.matches[1].str(), object_id, tree_size.value_or(0));
+      json out = {
+        {"object_id",  object_id},
+        {"leaf_index", p.leaf_index},
+        {"tree_size",  p.tree_size},
+        {"leaf_hash",  toHex(p.leaf_hash)},
+        {"path",       digests_json(p.path)}
+      };
+      res.status = 200;
+      res.set_content(out.dump(), "application/json");
+    } catch (const std::out_of_range& e) {
+      res.status = 404; res.set_content(e.what(), "text/plain");
+    } catch (const std::exception& e) {
+      spdlog::error("inclusion proof failed: {}", e.what());
+      res.status = 500; res.set_content("proof failed", "text/plain");
+    }
+  });
+
+  // GET /missions/<mission_id>/manifest/consistency?from=M[&to=N]
+  // Proof that manifest version M is a prefix of version N (to defaults to latest).
+  svr.Get(R"(/missions/([^/]+)/manifest/consistency)", [&](const httplib::Request& req, httplib::Response& res) {
+    if (!check_api_key(req, apiKey, res)) return;
+    const std::string mission_id = req.matches[1].str();
+    bool ok = true;
+    const auto from = param_size(req, "from", ok);
+    const auto to_param = param_size(req, "to", ok);
+    if (!ok || !from) { res.status = 422; res.set_content("from (and optional to) must be positive integers", "text/plain"); return; }
+    uint64_t to = 0;
+    if (to_param) {
+      to = *to_param;
+    } else {
+      auto latest = manifest.head(mission_id);
+      if (!latest) { res.status = 404; res.set_content("no manifest", "text/plain"); return; }
+      to = latest->tree_size;
+    }
+    if (*from > to) { res.status = 422; res.set_content("from must not exceed to", "text/plain"); return; }
+    try {
+      auto proof = manifest.consistencyProof(mission_id, *from, to);
+      json out = {
+        {"from",  *from},
+        {"to",    to},
+        {"proof", digests_json(proof)}
+      };
+      res.status = 200;
+      res.set_content(out.dump(), "application/json");
+    } catch (const std::out_of_range& e) {
+      res.status = 404; res.set_content(e.what(), "text/plain");
+    } catch (const std::exception& e) {
+      spdlog::error("consistency proof failed: {}", e.what());
+      res.status = 500; res.set_content("proof failed", "text/plain");
+    }
+  });
+
   // Fallback
   svr.set_error_handler([](const httplib::Request&, httplib::Response& res) {
     if (res.status == 404) res.set_content("not found", "text/plain");
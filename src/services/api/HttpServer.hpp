@@ -3,12 +3,14 @@
 
 class MetadataStore;
 class LocalFSBackend;
+class MissionManifest;
 
 namespace mdm {
   // Starts a blocking HTTP server.
   // If apiKey is empty, auth is disabled (useful for early integration).
   void run_http_server(MetadataStore& store,
                        LocalFSBackend& fs,
+                       MissionManifest& manifest,
                        int port,
                        const std::string& apiKey);
 }
@@ -0,0 +1,206 @@
+// tests/crypto_tests.cpp
+// Known-answer tests for Hash and round-trip/negative tests for the
+// Merkle mission manifest in Sign. Plain executable registered with CTest.
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/crypto/Hash.hpp"
+#include "core/crypto/Sign.hpp"
+#include "core/metadata/InitDb.hpp"
+#include "core/metadata/MetadataStore.hpp"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                     \
+  do {                                                                  \
+    if (!(cond)) {                                                      \
+      ++failures;                                                       \
+      std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+    }                                                                   \
+  } while (0)
+
+template <class E, class F>
+static bool throws(F&& f) {
+  try { f(); } catch (const E&) { return true; } catch (...) { return false; }
+  return false;
+}
+
+static void testSha256() {
+  CHECK(sha256Hex("") == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  CHECK(sha256Hex("abc") == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  CHECK(sha256Hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+        "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+  CHECK(sha256Hex(std::string(1000000, 'a')) ==
+        "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+  CHECK(!sha256File("/nonexistent/mdm-crypto-tests"));
+}
+
+static void testHmac() {
+  // RFC 4231 test cases 1, 2 and 6 (key longer than the block size)
+  CHECK(toHex(hmacSha256(std::string(20, '\x0b'), "Hi There")) ==
+        "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7");
+  CHECK(toHex(hmacSha256("Jefe", "what do ya want for nothing?")) ==
+        "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+  CHECK(toHex(hmacSha256(std::string(131, '\xaa'), "Test Using Larger Than Block-Size Key - Hash Key First")) ==
+        "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+}
+
+static void testHex() {
+  const std::string h = sha256Hex("abc");
+  CHECK(toHex(digestFromHex(h)) == h);
+  CHECK(throws<std::invalid_argument>([] { digestFromHex("abc"); }));
+  CHECK(throws<std::invalid_argument>([] { digestFromHex(std::string(64, 'g')); }));
+}
+
+// Naive MTH (RFC 6962 2.1) over all leaves, for comparison.
+static Digest naiveRoot(const std::vector<Digest>& leaves, size_t lo, size_t hi) {
+  if (hi - lo == 1) return leaves[lo];
+  size_t k = 1;
+  while (k * 2 < hi - lo) k *= 2;
+  return merkleNodeHash(naiveRoot(leaves, lo, lo + k), naiveRoot(leaves, lo + k, hi));
+}
+
+static void testManifest(const std::string& dbPath) {
+  MetadataStore store(dbPath);
+  MissionManifest manifest(store, "test-key");
+
+  const uint64_t N = 70;   // covers powers of two and ragged sizes
+  std::vector<Digest> leaves;
+  std::vector<TreeHead> heads;
+  for (uint64_t i = 0; i < N; ++i) {
+    const std::string sha = sha256Hex("object-" + std::to_string(i));
+    leaves.push_back(merkleLeafHash(digestFromHex(sha)));
+    heads.push_back(manifest.append("M1", "obj-" + std::to_string(i), sha, static_cast<int64_t>(i)));
+  }
+
+  for (uint64_t n = 1; n <= N; ++n) {
+    const TreeHead& th = heads[n - 1];
+    CHECK(th.tree_size == n);
+    CHECK(th.root == naiveRoot(leaves, 0, n));
+    auto stored = manifest.head("M1", n);
+    CHECK(stored && stored->root == th.root && manifest.verifySignature(*stored));
+
+    for (uint64_t i = 0; i < n; ++i) {
+      auto p = manifest.inclusionProof("M1", "obj-" + std::to_string(i), n);
+      CHECK(p.leaf_index == i && p.leaf_hash == leaves[i]);
+      CHECK(verifyInclusion(p.leaf_hash, i, n, p.path, th.root));
+    }
+
+    for (uint64_t m = 1; m <= n; ++m) {
+      auto c = manifest.consistencyProof("M1", m, n);
+      CHECK(verifyConsistency(m, heads[m - 1].root, n, th.root, c));
+    }
+  }
+
+  // Negative cases
+  const uint64_t n = 13, i = 6;
+  const Digest& root = heads[n - 1].root;
+  auto p = manifest.inclusionProof("M1", "obj-6", n);
+  CHECK(verifyInclusion(p.leaf_hash, i, n, p.path, root));
+  for (size_t k = 0; k < p.path.size(); ++k) {
+    auto bad = p.path;
+    bad[k][0] ^= 0x01;
+    CHECK(!verifyInclusion(p.leaf_hash, i, n, bad, root));
+  }
+  CHECK(!verifyInclusion(p.leaf_hash, i + 1, n, p.path, root));
+  CHECK(!verifyInclusion(p.leaf_hash, n, n, p.path, root));
+  CHECK(!verifyInclusion(p.leaf_hash, i, n, p.path, heads[n - 2].root));
+
+  auto c = manifest.consistencyProof("M1", 5, n);
+  CHECK(verifyConsistency(5, heads[4].root, n, root, c));
+  auto badc = c;
+  badc.back()[31] ^= 0x80;
+  CHECK(!verifyConsistency(5, heads[4].root, n, root, badc));
+  CHECK(!verifyConsistency(6, heads[4].root, n, root, c));
+  CHECK(!verifyConsistency(n, root, 5, heads[4].root, c));
+  CHECK(throws<std::out_of_range>([&] { manifest.consistencyProof("M1", n, 5); }));
+  CHECK(throws<std::out_of_range>([&] { manifest.consistencyProof("M1", 1, N + 1); }));
+  CHECK(throws<std::out_of_range>([&] { manifest.inclusionProof("M1", "obj-20", 10); }));
+  CHECK(throws<std::out_of_range>([&] { manifest.inclusionProof("M1", "missing", 0); }));
+
+  // Signatures bind the root
+  TreeHead forged = heads[n - 1];
+  forged.root = heads[n - 2].root;
+  CHECK(!manifest.verifySignature(forged));
+
+  // Duplicate object ids are rejected; a failed append inside a transaction
+  // rolls back the object row written with it.
+  ObjectRecord rec{"dup-row", "n", "M1", "", "", "", "{}", 1, sha256Hex("x"), "HOT", "p", 0, 0, "", "", 0, ""};
+  CHECK(throws<std::runtime_error>([&] {
+    store.inTransaction([&] {
+      store.insertObject(rec);
+      manifest.append("M1", "obj-0", rec.sha256, 0);
+    });
+  }));
+  CHECK(manifest.head("M1")->tree_size == N);
+  store.inTransaction([&] {
+    store.insertObject(rec);   // would hit the PK if the first insert had leaked
+    manifest.append("M1", rec.id, rec.sha256, 0);
+  });
+  CHECK(manifest.head("M1")->tree_size == N + 1);
+
+  // Backfill re-derives digests from stored bytes: a pre-upgrade placeholder
+  // digest is corrected before signing, unreadable objects are skipped.
+  const std::string bytesPath = dbPath + ".obj";
+  { std::ofstream(bytesPath, std::ios::binary) << "pre-upgrade bytes"; }
+  ObjectRecord fake{"pre-upgrade", "n", "M2", "", "", "", "{}", 17,
+                    "1f2e3d4c5b6a7980" + std::string(48, '0'), "HOT", bytesPath, 0, 0, "", "", 0, ""};
+  ObjectRecord gone{"no-bytes", "n", "M2", "", "", "", "{}", 1, sha256Hex("gone"), "HOT",
+                    dbPath + ".missing", 1, 1, "", "", 0, ""};
+  {
+    const std::string big(200000, 'z');   // spans several read chunks
+    { std::ofstream(bytesPath + ".big", std::ios::binary) << big; }
+    auto d = sha256File(bytesPath + ".big");
+    CHECK(d && *d == sha256(big));
+    std::filesystem::remove(bytesPath + ".big");
+  }
+  store.insertObject(fake);
+  store.insertObject(gone);
+  MissionManifest unsignedManifest(store, "");
+  CHECK(throws<std::logic_error>([&] { unsignedManifest.backfill(1); }));
+  CHECK(!manifest.head("M2"));
+  auto report = manifest.backfill(1);
+  CHECK(report.appended == 1 && report.rehashed == 1);
+  CHECK(report.skipped.size() == 1 && report.skipped[0] == "no-bytes");
+  CHECK(manifest.inclusionProof("M2", "pre-upgrade").leaf_hash ==
+        merkleLeafHash(sha256("pre-upgrade bytes")));
+  CHECK(throws<std::out_of_range>([&] { manifest.inclusionProof("M2", "no-bytes"); }));
+  auto again = manifest.backfill(1);
+  CHECK(again.appended == 0 && again.rehashed == 0 && again.skipped.size() == 1);
+  CHECK(manifest.head("M2") && manifest.head("M2")->tree_size == 1);
+  std::filesystem::remove(bytesPath);
+}
+
+int main() {
+  namespace fs = std::filesystem;
+  const fs::path dbPath = fs::temp_directory_path() /
+                          ("mdm-crypto-tests-" + std::to_string(std::time(nullptr)) + ".db");
+  fs::remove(dbPath);
+
+  try {
+    testSha256();
+    testHmac();
+    testHex();
+    initDatabase(dbPath.string(), MDM_SCHEMA_PATH);
+    testManifest(dbPath.string());
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "unexpected exception: %s\n", e.what());
+    ++failures;
+  }
+
+  std::error_code ec;
+  for (const char* suffix : {"", "-wal", "-shm"}) fs::remove(dbPath.string() + suffix, ec);
+
+  if (failures) {
+    std::fprintf(stderr, "%d check(s) failed\n", failures);
+    return 1;
+  }
+  std::puts("all crypto tests passed");
+  return 0;
+}